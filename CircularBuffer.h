@@ -4,9 +4,20 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
 
 
-template<typename value_type>
+// Policy: Defines what push_back/push_front/insert do when the buffer is full
+enum class FullBufferPolicy {
+    overwrite, // Overwrite the element on the opposite end (default)
+    reject,    // Leave the buffer untouched and return false
+    grow       // Double the capacity (amortized O(1) per push) and keep every element
+};
+
+template<typename value_type, FullBufferPolicy policy = FullBufferPolicy::overwrite>
 class CircularBuffer {
 private:
     value_type *buffer;  // Pointer to the buffer that holds the elements
@@ -17,6 +28,41 @@ private:
     int buffer_size;     // Current number of elements in the buffer
     int buffer_capacity; // Maximum capacity of the buffer
 
+    // Method: Moves the first min(size, new_capacity) elements into a new allocation of new_capacity,
+    //         relocating the two live segments [begin, capacity) and [0, end) with bulk moves
+    void relocate(int new_capacity) {
+        auto *new_buffer = new value_type[new_capacity];
+
+        int count = std::min(this->buffer_size, new_capacity);
+        int first_segment = std::min(count, this->buffer_capacity - this->begin);
+
+        std::move(this->buffer + this->begin, this->buffer + this->begin + first_segment, new_buffer);
+        std::move(this->buffer, this->buffer + (count - first_segment), new_buffer + first_segment);
+
+        delete[] this->buffer;
+        this->buffer = new_buffer;
+        this->buffer_capacity = new_capacity;
+        this->buffer_size = count;
+        this->begin = 0;
+        this->end = count == new_capacity ? 0 : count;
+    }
+
+    // Method: Returns the number of elements stored between begin and the end of the allocation
+    [[nodiscard]] int first_segment_size() const {
+        return std::min(this->buffer_size, this->buffer_capacity - this->begin);
+    }
+
+    // Method: Applies the full-buffer policy before adding an element, returns false if the element must be dropped
+    bool make_room() {
+        if (!this->full()) { return true; }
+        if constexpr (policy == FullBufferPolicy::reject) {
+            return false;
+        } else if constexpr (policy == FullBufferPolicy::grow) {
+            this->relocate(this->buffer_capacity > 0 ? this->buffer_capacity * 2 : 1);
+        }
+        return true;
+    }
+
 public:
     // Constructor: Creates an empty circular buffer with zero capacity
     CircularBuffer() {
@@ -76,30 +122,32 @@ public:
         }
     }
 
-    // Access operator: Provides direct access to the element at the specified index, wrapping around the buffer
+    // Access operator: Provides direct access to the element at the specified index counted from the front,
+    //                  wrapping around the buffer
     value_type &operator[](int i) {
-        return this->buffer[i % this->size()];
+        return this->buffer[(this->begin + i % this->size()) % this->buffer_capacity];
     }
 
-    // Const access operator: Provides read-only access to the element at the specified index, wrapping around the buffer
+    // Const access operator: Provides read-only access to the element at the specified index counted from the front,
+    //                        wrapping around the buffer
     const value_type &operator[](int i) const {
-        return this->buffer[i % this->size()];
+        return this->buffer[(this->begin + i % this->size()) % this->buffer_capacity];
     }
 
     // Access method: Returns a reference to the element at the specified index, throws if index is out of range
     value_type &at(int i) {
-        if (i % this->size() < this->size()) {
-            return this->buffer[i % this->size()];
+        if (i < 0 || i >= this->size()) {
+            throw std::out_of_range("The index is not from a filled circular buffer");
         }
-        throw std::invalid_argument("The index is not from a filled circular buffer");
+        return this->buffer[(this->begin + i) % this->buffer_capacity];
     }
 
     // Const access method: Returns a read-only reference to the element at the specified index, throws if index is out of range
     [[nodiscard]] const value_type &at(int i) const {
-        if (i % this->size() < this->size()) {
-            return this->buffer[i % this->size()];
+        if (i < 0 || i >= this->size()) {
+            throw std::out_of_range("The index is not from a filled circular buffer");
         }
-        throw std::invalid_argument("The index is not from a filled circular buffer");
+        return this->buffer[(this->begin + i) % this->buffer_capacity];
     }
 
     // Method: Returns a reference to the first element in the buffer, throws if the buffer is empty
@@ -111,7 +159,7 @@ public:
     // Method: Returns a reference to the last element in the buffer, throws if the buffer is empty
     value_type &back() {
         if (this->size() == 0) { throw std::out_of_range("buffer is empty"); }
-        if (this->end - 1 < 0) { return this->buffer[this->buffer_size - 1]; }
+        if (this->end - 1 < 0) { return this->buffer[this->buffer_capacity - 1]; }
         return this->buffer[this->end - 1];
     }
 
@@ -124,7 +172,7 @@ public:
     // Const method: Returns a read-only reference to the last element in the buffer, throws if the buffer is empty
     [[nodiscard]] const value_type &back() const {
         if (this->size() == 0) { throw std::out_of_range("buffer is empty"); }
-        if (this->end - 1 < 0) { return this->buffer[this->buffer_size - 1]; }
+        if (this->end - 1 < 0) { return this->buffer[this->buffer_capacity - 1]; }
         return this->buffer[this->end - 1];
     }
 
@@ -151,6 +199,26 @@ public:
         return this->begin == 0;
     }
 
+    // Method: Returns the first contiguous segment of stored elements, [begin, min(begin + size, capacity))
+    std::span<value_type> array_one() {
+        return {this->buffer + this->begin, static_cast<size_t>(this->first_segment_size())};
+    }
+
+    // Const method: Returns the first contiguous segment of stored elements as read-only
+    [[nodiscard]] std::span<const value_type> array_one() const {
+        return {this->buffer + this->begin, static_cast<size_t>(this->first_segment_size())};
+    }
+
+    // Method: Returns the second contiguous segment of stored elements (the wrapped part), empty if not wrapped
+    std::span<value_type> array_two() {
+        return {this->buffer, static_cast<size_t>(this->buffer_size - this->first_segment_size())};
+    }
+
+    // Const method: Returns the second contiguous segment of stored elements as read-only
+    [[nodiscard]] std::span<const value_type> array_two() const {
+        return {this->buffer, static_cast<size_t>(this->buffer_size - this->first_segment_size())};
+    }
+
     // Method: Rotates the buffer so that the element at the new_begin index becomes the first element.
     void rotate(int new_begin) {
         if (new_begin < 0 || new_begin >= this->buffer_size) {
@@ -184,22 +252,7 @@ public:
             return; // No change needed
         }
 
-        auto *new_buffer = new value_type[new_capacity];
-
-        int num_elements_to_copy = std::min(this->buffer_size, new_capacity);
-
-        for (int i = 0; i < num_elements_to_copy; ++i) {
-            new_buffer[i] = this->buffer[(this->begin + i) % this->buffer_capacity];
-        }
-
-        delete[] this->buffer;
-        this->buffer = new_buffer;
-        this->buffer_capacity = new_capacity;
-
-        this->buffer_size = num_elements_to_copy;
-
-        this->begin = 0;
-        this->end = num_elements_to_copy;
+        this->relocate(new_capacity);
     }
 
     // Method: Resizes the buffer to a new size. If the new size is greater than the current size,
@@ -253,8 +306,10 @@ public:
         }
     }
 
-    // Method: Adds a new element to the back of the buffer, overwriting the front element if the buffer is full
-    void push_back(const value_type &item = value_type()) {
+    // Method: Adds a new element to the back of the buffer. If the buffer is full, the policy decides:
+    //         overwrite the front element, reject the element (returns false) or grow the capacity
+    bool push_back(const value_type &item = value_type()) {
+        if (!this->make_room()) { return false; }
         if (this->full()) {  // Rewrite front element if full
             this->buffer[this->end++] = item;
             ++this->begin;
@@ -264,16 +319,22 @@ public:
             ++this->buffer_size;
         }
         if (this->end == this->buffer_capacity) { this->end = 0; }
+        return true;
     }
 
-    // Method: Adds a new element to the front of the buffer, overwriting the back element if the buffer is full
-    void push_front(const value_type &item = value_type()) {
-        if (!(this->full())) {  // Not overwrite back element
+    // Method: Adds a new element to the front of the buffer. If the buffer is full, the policy decides:
+    //         overwrite the back element, reject the element (returns false) or grow the capacity
+    bool push_front(const value_type &item = value_type()) {
+        if (!this->make_room()) { return false; }
+        bool overwrite = this->full();
+        if (!overwrite) {  // Not overwrite back element
             this->buffer_size += 1;
         }
         --begin;
         if (begin < 0) { begin = this->capacity() - 1; }
         this->buffer[begin] = item;
+        if (overwrite) { this->end = this->begin; }  // The old back element is gone
+        return true;
     }
 
     // Method: Removes the last element from the buffer, throws if the buffer is empty
@@ -290,7 +351,7 @@ public:
 
     // Method: Removes the first element from the buffer, throws if the buffer is empty
     void pop_front() {
-        if (begin == end) {
+        if (this->empty()) {
             throw std::out_of_range("there is no items in buffer");
         } else {
             this->buffer[this->begin] = {};
@@ -300,12 +361,29 @@ public:
         }
     }
 
-    // Method: Inserts a new element at the specified position, shifts elements as necessary,
-    //         may overwrite the front element if the buffer is full
-    void insert(int pos, const value_type &item = value_type()) {
+    // Method: Removes the first n elements at once, resetting the freed slots segment by segment,
+    //         throws if n is larger than the number of stored elements
+    void erase_begin(int n) {
+        if (n < 0 || n > this->size()) {
+            throw std::out_of_range("Invalid count for erase_begin");
+        }
+        if (n == 0) { return; }
+        int first_segment = std::min(n, this->first_segment_size());
+
+        std::fill(this->buffer + this->begin, this->buffer + this->begin + first_segment, value_type{});
+        std::fill(this->buffer, this->buffer + (n - first_segment), value_type{});
+
+        this->begin = (this->begin + n) % this->buffer_capacity;
+        this->buffer_size -= n;
+    }
+
+    // Method: Inserts a new element at the specified position, shifts elements as necessary.
+    //         If the buffer is full, the policy decides: remove the front element, reject (returns false) or grow
+    bool insert(int pos, const value_type &item = value_type()) {
         if (pos < 0 || pos > this->size()) {
             throw std::out_of_range("Position out of range");
         }
+        if (!this->make_room()) { return false; }
         if (this->full()) {
             pop_front(); // Remove front element if buffer is full
         }
@@ -315,6 +393,8 @@ public:
         }
         this->buffer[(this->begin + pos) % this->buffer_capacity] = item;
         ++this->buffer_size;
+        this->end = (this->begin + this->buffer_size) % this->buffer_capacity;
+        return true;
     }
 
     // Method: Removes elements from the buffer in the specified range [first, last)
@@ -342,14 +422,14 @@ public:
 };
 
 // Checks if two circular buffers are not equal
-template<class T>
-bool operator!=(const CircularBuffer<T> &a, const CircularBuffer<T> &b) {
+template<class T, FullBufferPolicy P>
+bool operator!=(const CircularBuffer<T, P> &a, const CircularBuffer<T, P> &b) {
     return !(a == b);
 }
 
 // Checks if two circular buffers are equal
-template<class T>
-bool operator==(const CircularBuffer<T> &a, const CircularBuffer<T> &b) {
+template<class T, FullBufferPolicy P>
+bool operator==(const CircularBuffer<T, P> &a, const CircularBuffer<T, P> &b) {
     if (a.size() != b.size()) { return false; }
     if (a.capacity() != b.capacity()) { return false; }
     if (a.capacity() > 0) {
@@ -362,4 +442,131 @@ bool operator==(const CircularBuffer<T> &a, const CircularBuffer<T> &b) {
     return true;
 }
 
+// Circular buffer whose elements are ordered by a monotonic (non-decreasing) key, e.g. a timestamp.
+// key_extractor maps a stored element to its key; push_back rejects elements that would break the key order,
+// and only order-preserving members of CircularBuffer are exposed.
+// Lookups binary-search the two live segments, so window maintenance is O(log n) per call.
+template<typename value_type, typename key_extractor, FullBufferPolicy policy = FullBufferPolicy::overwrite>
+class KeyedCircularBuffer : private CircularBuffer<value_type, policy> {
+private:
+    using base = CircularBuffer<value_type, policy>;
+
+    key_extractor key_of; // Maps an element to its key
+
+    // Stateless extractors (e.g. a functor type) need no instance; stateful ones such as std::function
+    // or a function pointer must be passed to the constructor
+    static constexpr bool stateless_extractor =
+            std::is_empty_v<key_extractor> && std::is_default_constructible_v<key_extractor>;
+
+    // Method: Returns the logical index of the first element for which below(key_of(element)) is false
+    template<typename predicate>
+    [[nodiscard]] int partition_point(predicate below) const {
+        auto one = base::array_one();
+        auto two = base::array_two();
+        auto element_below = [&](const value_type &elem) { return below(std::invoke(this->key_of, elem)); };
+
+        if (!two.empty() && element_below(one.back())) {
+            return static_cast<int>(one.size() + (std::ranges::partition_point(two, element_below) - two.begin()));
+        }
+        return static_cast<int>(std::ranges::partition_point(one, element_below) - one.begin());
+    }
+
+    // Method: Splits the logical range [first, last) into its parts inside the two live segments
+    template<typename span_type>
+    static std::pair<span_type, span_type> slice(span_type one, span_type two, int first, int last) {
+        auto one_size = static_cast<int>(one.size());
+        int one_first = std::min(first, one_size);
+        int one_last = std::min(last, one_size);
+        int two_first = std::max(first, one_size) - one_size;
+        int two_last = std::max(last, one_size) - one_size;
+        return {one.subspan(one_first, one_last - one_first), two.subspan(two_first, two_last - two_first)};
+    }
+
+public:
+    using key_type = std::remove_cvref_t<std::invoke_result_t<const key_extractor &, const value_type &>>;
+    using segments = std::pair<std::span<value_type>, std::span<value_type>>;
+    using const_segments = std::pair<std::span<const value_type>, std::span<const value_type>>;
+
+    // Constructor: Creates an empty keyed buffer with zero capacity, only for stateless key extractors
+    KeyedCircularBuffer() requires stateless_extractor = default;
+
+    // Constructor: Creates an empty keyed buffer with a specified capacity, only for stateless key extractors
+    explicit KeyedCircularBuffer(int capacity) requires stateless_extractor
+            : CircularBuffer<value_type, policy>(capacity) {}
+
+    // Constructor: Creates an empty keyed buffer with a specified capacity and key extractor
+    KeyedCircularBuffer(int capacity, key_extractor key) : CircularBuffer<value_type, policy>(capacity),
+                                                           key_of(std::move(key)) {}
+
+    using base::size;
+    using base::empty;
+    using base::full;
+    using base::reserve;
+    using base::capacity;
+    using base::set_capacity;
+    using base::is_linearized;
+    using base::pop_front;
+    using base::pop_back;
+    using base::erase_begin;
+    using base::clear;
+
+    // Const access operator: Provides read-only access to the element at the specified index counted from the front
+    const value_type &operator[](int i) const { return base::operator[](i); }
+
+    // Const access method: Returns a read-only reference to the element at the specified index
+    [[nodiscard]] const value_type &at(int i) const { return base::at(i); }
+
+    // Const method: Returns a read-only reference to the element with the smallest key, throws if the buffer is empty
+    [[nodiscard]] const value_type &front() const { return base::front(); }
+
+    // Const method: Returns a read-only reference to the element with the largest key, throws if the buffer is empty
+    [[nodiscard]] const value_type &back() const { return base::back(); }
+
+    // Const method: Returns the first contiguous segment of stored elements as read-only
+    [[nodiscard]] std::span<const value_type> array_one() const { return base::array_one(); }
+
+    // Const method: Returns the second contiguous segment of stored elements as read-only
+    [[nodiscard]] std::span<const value_type> array_two() const { return base::array_two(); }
+
+    // Method: Adds a new element to the back of the buffer, full-buffer handling follows the policy,
+    //         throws if its key is less than the key of the current back element
+    bool push_back(const value_type &item) {
+        if (!this->empty() && std::invoke(this->key_of, item) < std::invoke(this->key_of, this->back())) {
+            throw std::invalid_argument("Key is less than the key of the back element");
+        }
+        return base::push_back(item);
+    }
+
+    // Method: Returns the logical index of the first element whose key is not less than key
+    [[nodiscard]] int lower_bound(const key_type &key) const {
+        return this->partition_point([&](const key_type &k) { return k < key; });
+    }
+
+    // Method: Returns the logical index of the first element whose key is greater than key
+    [[nodiscard]] int upper_bound(const key_type &key) const {
+        return this->partition_point([&](const key_type &k) { return !(key < k); });
+    }
+
+    // Method: Removes every element whose key is less than key, returns the number of removed elements
+    int evict_before(const key_type &key) {
+        int count = this->lower_bound(key);
+        this->erase_begin(count);
+        return count;
+    }
+
+    // Method: Returns the elements with keys in [first, last) as up to two contiguous spans
+    segments range(const key_type &first, const key_type &last) {
+        int from = this->lower_bound(first);
+        int to = std::max(from, this->lower_bound(last));
+        return slice(base::array_one(), base::array_two(), from, to);
+    }
+
+    // Const method: Returns the elements with keys in [first, last) as up to two read-only spans
+    [[nodiscard]] const_segments range(const key_type &first, const key_type &last) const {
+        int from = this->lower_bound(first);
+        int to = std::max(from, this->lower_bound(last));
+        return slice(this->array_one(), this->array_two(), from, to);
+    }
+};
+
 #endif //CIRCULARBUFFER_CIRCULARBUFFER_H
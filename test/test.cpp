@@ -128,7 +128,8 @@ TEST(Methods, push) {
 
     cbb.push_front({});
     cbb.push_front({});
-    ASSERT_EQ(cbb.front(), cbb.back());
+    ASSERT_EQ(cbb.front(), cbb[1]);
+    ASSERT_EQ(cbb.back(), s);
     cbb.push_back(s);
     ASSERT_NE(cbb.front(), cbb.back());
 }
@@ -230,6 +231,17 @@ TEST(Methods, rotate) {
     ASSERT_EQ(cb.front(), 3);
 }
 
+TEST(Indexing, wrapped) {
+    CircularBuffer<int> cb(3);
+    for (int i = 0; i < 5; ++i) {
+        cb.push_back(i);
+    }
+    ASSERT_EQ(cb[0], 2);
+    ASSERT_EQ(cb[1], 3);
+    ASSERT_EQ(cb.at(2), 4);
+    ASSERT_EQ(cb[3], 2);
+}
+
 TEST(Methods, insert) {
     CircularBuffer<int> cb(5);
     cb.push_back(1);
@@ -254,6 +266,33 @@ TEST(Methods, erase) {
     ASSERT_EQ(cb[1], 4);
 }
 
+TEST(Methods, erase_begin) {
+    CircularBuffer<int> cb(4);
+    for (int i = 0; i < 6; ++i) {
+        cb.push_back(i);
+    }
+    // Stored 2 3 | 4 5, wrapped across both segments
+    ASSERT_EQ(std::vector<int>(cb.array_one().begin(), cb.array_one().end()), (std::vector<int>{2, 3}));
+    ASSERT_EQ(std::vector<int>(cb.array_two().begin(), cb.array_two().end()), (std::vector<int>{4, 5}));
+
+    cb.erase_begin(3);
+    ASSERT_EQ(cb.size(), 1);
+    ASSERT_EQ(cb.front(), 5);
+    ASSERT_EQ(cb.back(), 5);
+    ASSERT_EQ(std::vector<int>(cb.array_one().begin(), cb.array_one().end()), (std::vector<int>{5}));
+    ASSERT_TRUE(cb.array_two().empty());
+    ASSERT_THROW(cb.erase_begin(2), std::out_of_range);
+
+    cb.push_back(6);
+    cb.push_back(7);
+    ASSERT_EQ(cb.size(), 3);
+    ASSERT_EQ(cb.front(), 5);
+    ASSERT_EQ(cb.back(), 7);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(cb[i], 5 + i);
+    }
+}
+
 TEST(Methods, set_capacity) {
     CircularBuffer<int> cb(5);
 
@@ -299,6 +338,20 @@ TEST(Exceptions, rotate_out_of_bounds) {
     ASSERT_THROW(cb.rotate(5), std::out_of_range);
 }
 
+TEST(Exceptions, at_out_of_bounds) {
+    CircularBuffer<int> cb(3);
+    ASSERT_THROW(cb.at(0), std::out_of_range);
+
+    cb.push_back(1);
+    cb.push_back(2);
+    ASSERT_EQ(cb.at(1), 2);
+    ASSERT_THROW(cb.at(cb.size()), std::out_of_range);
+    ASSERT_THROW(cb.at(-1), std::out_of_range);
+
+    const auto &ccb = cb;
+    ASSERT_THROW((void) ccb.at(ccb.size()), std::out_of_range);
+}
+
 TEST(Exceptions, insert_out_of_bounds) {
     CircularBuffer<int> cb(5);
     cb.push_back(1);
@@ -314,3 +367,201 @@ TEST(Exceptions, erase_out_of_bounds) {
 
     ASSERT_THROW(cb.erase(1, 3), std::out_of_range);
 }
+
+TEST(Policies, overwrite) {
+    CircularBuffer<int> cb(2);
+    ASSERT_TRUE(cb.push_back(1));
+    ASSERT_TRUE(cb.push_back(2));
+    ASSERT_TRUE(cb.push_back(3));
+    ASSERT_EQ(cb.size(), 2);
+    ASSERT_EQ(cb.front(), 2);
+    ASSERT_EQ(cb.back(), 3);
+
+    ASSERT_TRUE(cb.push_front(1));
+    ASSERT_EQ(cb.size(), 2);
+    ASSERT_EQ(cb.front(), 1);
+    ASSERT_EQ(cb.back(), 2);
+    ASSERT_TRUE(cb.push_back(3));
+    ASSERT_EQ(cb.front(), 2);
+    ASSERT_EQ(cb.back(), 3);
+}
+
+TEST(Policies, overwrite_insert) {
+    CircularBuffer<int> cb(3);
+    cb.push_back(1);
+    cb.push_back(2);
+    cb.push_back(3);
+    ASSERT_TRUE(cb.insert(1, 9));
+    ASSERT_EQ(cb.size(), 3);
+    ASSERT_EQ(cb[0], 2);
+    ASSERT_EQ(cb[1], 9);
+    ASSERT_EQ(cb[2], 3);
+    ASSERT_EQ(cb.front(), 2);
+    ASSERT_EQ(cb.back(), 3);
+}
+
+TEST(Policies, reject) {
+    CircularBuffer<int, FullBufferPolicy::reject> cb(2);
+    ASSERT_TRUE(cb.push_back(1));
+    ASSERT_TRUE(cb.push_front(0));
+    ASSERT_FALSE(cb.push_back(2));
+    ASSERT_FALSE(cb.push_front(-1));
+    ASSERT_FALSE(cb.insert(1, 5));
+    ASSERT_EQ(cb.size(), 2);
+    ASSERT_EQ(cb.front(), 0);
+    ASSERT_EQ(cb.back(), 1);
+
+    // Draining a full buffer frees room for new elements
+    ASSERT_NO_THROW(cb.pop_front());
+    ASSERT_EQ(cb.front(), 1);
+    ASSERT_TRUE(cb.push_back(2));
+    ASSERT_EQ(cb.back(), 2);
+}
+
+TEST(Policies, grow) {
+    CircularBuffer<int, FullBufferPolicy::grow> cb;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(cb.push_back(i));
+    }
+    ASSERT_EQ(cb.size(), 100);
+    ASSERT_EQ(cb.capacity(), 128);
+    ASSERT_EQ(cb.front(), 0);
+    ASSERT_EQ(cb.back(), 99);
+
+    // Wrapped buffer keeps its order after relocation
+    CircularBuffer<int, FullBufferPolicy::grow> wrapped(4);
+    wrapped.push_back(2);
+    wrapped.push_back(3);
+    wrapped.push_front(1);
+    wrapped.push_front(0);
+    ASSERT_TRUE(wrapped.push_back(4));
+    ASSERT_EQ(wrapped.capacity(), 8);
+    ASSERT_TRUE(wrapped.is_linearized());
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(wrapped[i], i);
+    }
+    ASSERT_TRUE(wrapped.push_front(-1));
+    ASSERT_EQ(wrapped.front(), -1);
+    ASSERT_EQ(wrapped.size(), 6);
+}
+
+TEST(Policies, grow_insert) {
+    CircularBuffer<int, FullBufferPolicy::grow> cb(2);
+    cb.push_back(1);
+    cb.push_back(2);
+    ASSERT_TRUE(cb.insert(0, 0));
+    ASSERT_EQ(cb.capacity(), 4);
+    ASSERT_TRUE(cb.push_back(3));
+    ASSERT_EQ(cb.size(), 4);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(cb[i], i);
+    }
+    ASSERT_EQ(cb.back(), 3);
+}
+
+struct Record {
+    int timestamp;
+    int value;
+};
+
+struct RecordTimestamp {
+    int operator()(const Record &r) const { return r.timestamp; }
+};
+
+TEST(Keyed, bounds_and_evict) {
+    KeyedCircularBuffer<Record, RecordTimestamp> cb(5);
+    for (int t = 0; t < 8; ++t) {
+        cb.push_back({t * 10, t});
+    }
+    // Stored timestamps 30..70, wrapped across both segments
+    ASSERT_FALSE(cb.array_two().empty());
+    ASSERT_EQ(cb.lower_bound(0), 0);
+    ASSERT_EQ(cb.lower_bound(50), 2);
+    ASSERT_EQ(cb.lower_bound(55), 3);
+    ASSERT_EQ(cb.upper_bound(50), 3);
+    ASSERT_EQ(cb.upper_bound(70), 5);
+    ASSERT_EQ(cb.lower_bound(100), 5);
+    ASSERT_EQ(cb[cb.lower_bound(50)].timestamp, 50);
+    ASSERT_EQ(cb.at(cb.lower_bound(55)).timestamp, 60);
+    ASSERT_EQ(cb[cb.upper_bound(30)].timestamp, 40);
+    ASSERT_THROW((void) cb.at(cb.lower_bound(100)), std::out_of_range);
+
+    ASSERT_EQ(cb.evict_before(45), 2);
+    ASSERT_EQ(cb.size(), 3);
+    ASSERT_EQ(cb.front().timestamp, 50);
+    ASSERT_EQ(cb.evict_before(45), 0);
+}
+
+TEST(Keyed, pop_full_window) {
+    KeyedCircularBuffer<Record, RecordTimestamp> cb(4);
+    for (int t = 0; t < 6; ++t) {
+        cb.push_back({t * 10, t});
+    }
+    // Full window 20..50, wrapped across both segments
+    ASSERT_TRUE(cb.full());
+    ASSERT_FALSE(cb.array_two().empty());
+
+    ASSERT_NO_THROW(cb.pop_front());
+    ASSERT_EQ(cb.size(), 3);
+    ASSERT_EQ(cb.front().timestamp, 30);
+    ASSERT_EQ(cb.lower_bound(20), 0);
+    ASSERT_EQ(cb.lower_bound(45), 2);
+    ASSERT_EQ(cb[cb.lower_bound(45)].timestamp, 50);
+    ASSERT_EQ(cb.upper_bound(50), 3);
+
+    auto [one, two] = cb.range(35, 60);
+    std::vector<int> timestamps;
+    for (auto &r: one) { timestamps.push_back(r.timestamp); }
+    for (auto &r: two) { timestamps.push_back(r.timestamp); }
+    ASSERT_EQ(timestamps, (std::vector<int>{40, 50}));
+
+    cb.push_back({60, 6});
+    ASSERT_EQ(cb.back().timestamp, 60);
+    ASSERT_EQ(cb.lower_bound(60), 3);
+}
+
+TEST(Keyed, range) {
+    auto cb = KeyedCircularBuffer<Record, std::function<int(const Record &)>>(
+            5, [](const Record &r) { return r.timestamp; });
+    for (int t = 0; t < 7; ++t) {
+        cb.push_back({t, t * 100});
+    }
+    // Stored timestamps 2..6
+    decltype(cb)::segments found = cb.range(3, 6);
+    auto [one, two] = found;
+    ASSERT_EQ(one.size() + two.size(), 3);
+    std::vector<int> values;
+    for (auto &r: one) { values.push_back(r.value); }
+    for (auto &r: two) { values.push_back(r.value); }
+    ASSERT_EQ(values, (std::vector<int>{300, 400, 500}));
+
+    auto [empty_one, empty_two] = cb.range(10, 20);
+    ASSERT_TRUE(empty_one.empty() && empty_two.empty());
+}
+
+TEST(Keyed, construct) {
+    using stateful = KeyedCircularBuffer<Record, std::function<int(const Record &)>>;
+    using stateless = KeyedCircularBuffer<Record, RecordTimestamp>;
+
+    ASSERT_FALSE((std::is_constructible_v<stateful, int>));
+    ASSERT_FALSE(std::is_default_constructible_v<stateful>);
+    ASSERT_TRUE((std::is_constructible_v<stateless, int>));
+    ASSERT_TRUE(std::is_default_constructible_v<stateless>);
+    ASSERT_EQ(stateless().capacity(), 0);
+
+    stateless empty(3);
+    ASSERT_THROW((void) empty.at(empty.lower_bound(0)), std::out_of_range);
+}
+
+TEST(Keyed, key_order) {
+    KeyedCircularBuffer<Record, RecordTimestamp> cb(3);
+    cb.push_back({10, 0});
+    cb.push_back({10, 1});
+    ASSERT_THROW(cb.push_back({5, 2}), std::invalid_argument);
+    ASSERT_EQ(cb.size(), 2);
+    ASSERT_EQ(cb.back().value, 1);
+
+    // Only order-preserving members are reachable
+    ASSERT_FALSE((std::is_convertible_v<decltype(cb) &, CircularBuffer<Record> &>));
+    ASSERT_TRUE((std::is_same_v<decltype(cb[0]), const Record &>));
+}